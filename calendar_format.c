@@ -0,0 +1,303 @@
+/**
+ * @file calendar_format.c
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Allocation free ISO-8601 / RFC 3339 formatting and parsing.
+ * Avoids strftime / strptime so no locale handling or full libc is needed.
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <stdbool.h>
+#include <zcal/format.h>
+
+#define TM_BIAS_YEAR		1900
+#define SEC_PER_DAY		86400
+#define MSEC_PER_DAY		(SEC_PER_DAY * 1000LL)
+
+/* 0000-01-01T00:00:00.000Z and 9999-12-31T23:59:59.999Z */
+#define EPOCH_MS_MIN		(-62167219200000LL)
+#define EPOCH_MS_MAX		(253402300799999LL)
+
+/* Two ascii digits for every value 0-99, so digits are emitted in pairs */
+static const char zcal_digits[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+struct zcal_datetime{
+	int year;
+	int mon;	/* 1-12 */
+	int mday;	/* 1-31 */
+	int hour;
+	int min;
+	int sec;
+	int msec;
+};
+
+static inline bool is_leap_year(int year){
+	return (year % 4 == 0) && ((year % 100 != 0) || (year % 400 == 0));
+}
+
+static inline int days_in_month(int year, int mon){
+	static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	return days[mon - 1] + ((mon == 2) && is_leap_year(year));
+}
+
+/**
+ * @brief Days since January 1 1970 of a civil date (proleptic gregorian)
+ * 
+ * @param year : full year, e.g. 2022
+ * @param mon : month 1-12
+ * @param mday : day of month 1-31
+ * @retval days since epoch, negative before 1970
+ */
+static int64_t days_from_civil(int year, int mon, int mday){
+	year -= mon <= 2;
+	const int64_t era = (year >= 0 ? year : year - 399) / 400;
+	const int yoe = year - era * 400;
+	const int doy = (153 * (mon + (mon > 2 ? -3 : 9)) + 2) / 5 + mday - 1;
+	const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+	return era * 146097 + doe - 719468;
+}
+
+/**
+ * @brief Civil date from days since January 1 1970. Inverse of `days_from_civil`
+ * 
+ * @param days : days since epoch
+ * @param dt : year, month and day are populated
+ */
+static void civil_from_days(int64_t days, struct zcal_datetime *dt){
+	days += 719468;
+	const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+	const int doe = (int)(days - era * 146097);
+	const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	const int mp = (5 * doy + 2) / 153;
+	dt->mday = doy - (153 * mp + 2) / 5 + 1;
+	dt->mon = mp < 10 ? mp + 3 : mp - 9;
+	dt->year = (int)(yoe + era * 400) + (dt->mon <= 2);
+}
+
+static inline int64_t floor_div(int64_t a, int64_t b){
+	return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static inline char *emit2(char *p, int v){
+	memcpy(p, &zcal_digits[v * 2], 2);
+	return p + 2;
+}
+
+static int zcal_emit(char *buf, size_t size, const struct zcal_datetime *dt,
+		     int16_t utc_offset_min, uint32_t flags){
+	size_t len = sizeof("YYYY-MM-DDTHH:MM:SS") - 1;
+	int offset = utc_offset_min;
+
+	if (dt->year < 0 || dt->year > 9999 || dt->mon < 1 || dt->mon > 12 ||
+	    dt->mday < 1 || dt->mday > 31 || dt->hour < 0 || dt->hour > 23 ||
+	    dt->min < 0 || dt->min > 59 || dt->sec < 0 || dt->sec > 60 ||
+	    dt->msec < 0 || dt->msec > 999 || dt->mday > days_in_month(dt->year, dt->mon)){
+		return -EINVAL;
+	}
+	if ((flags & ZCAL_FORMAT_OFFSET) && (offset <= -24 * 60 || offset >= 24 * 60)){
+		return -EINVAL;
+	}
+
+	len += (flags & ZCAL_FORMAT_MSEC) ? sizeof(".sss") - 1 : 0;
+	len += (flags & ZCAL_FORMAT_OFFSET) ? sizeof("+hh:mm") - 1 : 1;
+	if (buf == NULL || size < len + 1){
+		return -ENOMEM;
+	}
+
+	char *p = buf;
+	p = emit2(p, dt->year / 100);
+	p = emit2(p, dt->year % 100);
+	*p++ = '-';
+	p = emit2(p, dt->mon);
+	*p++ = '-';
+	p = emit2(p, dt->mday);
+	*p++ = 'T';
+	p = emit2(p, dt->hour);
+	*p++ = ':';
+	p = emit2(p, dt->min);
+	*p++ = ':';
+	p = emit2(p, dt->sec);
+
+	if (flags & ZCAL_FORMAT_MSEC){
+		*p++ = '.';
+		*p++ = '0' + dt->msec / 100;
+		p = emit2(p, dt->msec % 100);
+	}
+
+	if (flags & ZCAL_FORMAT_OFFSET){
+		*p++ = offset < 0 ? '-' : '+';
+		offset = offset < 0 ? -offset : offset;
+		p = emit2(p, offset / 60);
+		*p++ = ':';
+		p = emit2(p, offset % 60);
+	} else {
+		*p++ = 'Z';
+	}
+	*p = '\0';
+
+	return (int)(p - buf);
+}
+
+int zcal_format_tm(char *buf, size_t size, const struct tm *tm,
+		   uint16_t msec, int16_t utc_offset_min, uint32_t flags){
+	if (tm == NULL){
+		return -EINVAL;
+	}
+	const struct zcal_datetime dt = {
+		.year = tm->tm_year + TM_BIAS_YEAR,
+		.mon = tm->tm_mon + 1,
+		.mday = tm->tm_mday,
+		.hour = tm->tm_hour,
+		.min = tm->tm_min,
+		.sec = tm->tm_sec,
+		.msec = msec,
+	};
+	return zcal_emit(buf, size, &dt, utc_offset_min, flags);
+}
+
+int zcal_format_epoch(char *buf, size_t size, int64_t epoch_ms,
+		      int16_t utc_offset_min, uint32_t flags){
+	struct zcal_datetime dt;
+
+	/* Reject out of range input before any arithmetic, so nothing below can
+	* overflow. The offset is checked to be less than a day, so a local date
+	* outside of 0000-9999 is still rejected when emitting.
+	*/
+	if (epoch_ms < EPOCH_MS_MIN - MSEC_PER_DAY || epoch_ms > EPOCH_MS_MAX + MSEC_PER_DAY){
+		return -EINVAL;
+	}
+	if (flags & ZCAL_FORMAT_OFFSET){
+		if (utc_offset_min <= -24 * 60 || utc_offset_min >= 24 * 60){
+			return -EINVAL;
+		}
+		epoch_ms += (int64_t)utc_offset_min * 60 * 1000;
+	}
+	int64_t days = floor_div(epoch_ms, MSEC_PER_DAY);
+	int ms_of_day = (int)(epoch_ms - days * MSEC_PER_DAY);
+	int sec_of_day = ms_of_day / 1000;
+
+	civil_from_days(days, &dt);
+	dt.hour = sec_of_day / 3600;
+	dt.min = (sec_of_day / 60) % 60;
+	dt.sec = sec_of_day % 60;
+	dt.msec = ms_of_day % 1000;
+	return zcal_emit(buf, size, &dt, utc_offset_min, flags);
+}
+
+/**
+ * @brief Parse exactly `n` decimal digits
+ * 
+ * @retval value on success, or -1 if a character is not a digit
+ */
+static inline int parse_digits(const char *p, int n){
+	int v = 0;
+	for (int i = 0; i < n; i++){
+		unsigned int d = (unsigned int)(p[i] - '0');
+		if (d > 9){
+			return -1;
+		}
+		v = v * 10 + d;
+	}
+	return v;
+}
+
+int zcal_parse_rfc3339(const char *str, size_t len, struct tm *tm, uint16_t *msec){
+	struct zcal_datetime dt = {0};
+	int offset_min = 0;
+	size_t i = sizeof("YYYY-MM-DDTHH:MM:SS") - 1;
+
+	if (str == NULL || tm == NULL){
+		return -EINVAL;
+	}
+	len = strnlen(str, len);
+	if (len < i){
+		return -EINVAL;
+	}
+	if (str[4] != '-' || str[7] != '-' || str[13] != ':' || str[16] != ':' ||
+	    (str[10] != 'T' && str[10] != 't' && str[10] != ' ')){
+		return -EINVAL;
+	}
+
+	dt.year = parse_digits(&str[0], 4);
+	dt.mon = parse_digits(&str[5], 2);
+	dt.mday = parse_digits(&str[8], 2);
+	dt.hour = parse_digits(&str[11], 2);
+	dt.min = parse_digits(&str[14], 2);
+	dt.sec = parse_digits(&str[17], 2);
+
+	if (dt.year < 0 || dt.mon < 1 || dt.mon > 12 || dt.mday < 1 ||
+	    dt.mday > days_in_month(dt.year, dt.mon) || dt.hour < 0 || dt.hour > 23 ||
+	    dt.min < 0 || dt.min > 59 || dt.sec < 0 || dt.sec > 60){
+		return -EINVAL;
+	}
+	/* Leap seconds are not representable by the rtc backends, clamp to 59 */
+	dt.sec = dt.sec > 59 ? 59 : dt.sec;
+
+	if (i < len && str[i] == '.'){
+		int scale = 100;
+		i++;
+		if (i >= len || (unsigned int)(str[i] - '0') > 9){
+			return -EINVAL;
+		}
+		while (i < len && (unsigned int)(str[i] - '0') <= 9){
+			dt.msec += (str[i] - '0') * scale;
+			scale /= 10;
+			i++;
+		}
+	}
+
+	if (i < len && (str[i] == 'Z' || str[i] == 'z')){
+		i++;
+	} else if (i < len && (str[i] == '+' || str[i] == '-')){
+		if (len - i < sizeof("+hh:mm") - 1 || str[i + 3] != ':'){
+			return -EINVAL;
+		}
+		int hours = parse_digits(&str[i + 1], 2);
+		int mins = parse_digits(&str[i + 4], 2);
+		if (hours < 0 || hours > 23 || mins < 0 || mins > 59){
+			return -EINVAL;
+		}
+		offset_min = hours * 60 + mins;
+		offset_min = str[i] == '-' ? -offset_min : offset_min;
+		i += sizeof("+hh:mm") - 1;
+	}
+
+	/* Shift to utc, which may roll over into an adjacent day */
+	int64_t days = days_from_civil(dt.year, dt.mon, dt.mday);
+	int64_t sec_of_day = dt.hour * 3600 + dt.min * 60 + dt.sec - offset_min * 60;
+	days += floor_div(sec_of_day, SEC_PER_DAY);
+	sec_of_day -= floor_div(sec_of_day, SEC_PER_DAY) * SEC_PER_DAY;
+
+	civil_from_days(days, &dt);
+	tm->tm_year = dt.year - TM_BIAS_YEAR;
+	tm->tm_mon = dt.mon - 1;
+	tm->tm_mday = dt.mday;
+	tm->tm_hour = (int)(sec_of_day / 3600);
+	tm->tm_min = (int)((sec_of_day / 60) % 60);
+	tm->tm_sec = (int)(sec_of_day % 60);
+	/* January 1 1970 was a thursday */
+	tm->tm_wday = (int)((days + 4) - floor_div(days + 4, 7) * 7);
+	tm->tm_yday = (int)(days - days_from_civil(dt.year, 1, 1));
+	tm->tm_isdst = 0;
+
+	if (msec != NULL){
+		*msec = (uint16_t)dt.msec;
+	}
+	return (int)i;
+}
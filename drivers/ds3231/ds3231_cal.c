@@ -19,12 +19,17 @@
 
 #define DT_DRV_COMPAT calendar
 
-LOG_MODULE_REGISTER(calendar, CONFIG_CALENDAR_LOG_LEVEL);
+LOG_MODULE_REGISTER(calendar_ds3231, CONFIG_CALENDAR_LOG_LEVEL);
 
 struct ds3231_config{
 	const struct device * rtc_dev;
 };
 
+struct ds3231_data{
+	/* The oscillator stopped at some point, so the time is invalid until set */
+	bool osf;
+};
+
 /**
  * @brief Set the calendar time to the battery backed rtc domain. 
  * 
@@ -36,8 +41,9 @@ struct ds3231_config{
  * @retval 0 on success
  * @retval -errno on failure
  */
-static int ds3231_calendar_settime(const struct device * dev, struct tm * tm) {
+int ds3231_calendar_settime(const struct device * dev, struct tm * tm) {
 	int rc = 0;
+	struct ds3231_data * data = dev->data;
 	const struct ds3231_config * cfg = dev->config;
 	const struct device * rtc = cfg->rtc_dev;
 	uint32_t syncclock = maxim_ds3231_read_syncclock(rtc);
@@ -59,15 +65,29 @@ static int ds3231_calendar_settime(const struct device * dev, struct tm * tm) {
 	sys_notify_init_signal(&notify, &ss);
 
 	rc = maxim_ds3231_set(rtc, &sp, &notify);
+	if (rc < 0){
+		return rc;
+	}
 
 	/* Wait for the set to complete. It should never take more than one second */
 	rc = k_poll(&sevt, 1, K_MSEC(1000));
+	if (rc != 0){
+		return rc;
+	}
 	rc = maxim_ds3231_get_syncpoint(rtc, &sp);
 	LOG_DBG("wrote sync %d: %u %u at %u", rc,
 	       (uint32_t)sp.rtc.tv_sec, (uint32_t)sp.rtc.tv_nsec,
 	       sp.syncclock);
 
-	return rc;
+	/* The time is valid again, so the oscillator fault can be cleared */
+	if (rc >= 0 && data->osf){
+		rc = maxim_ds3231_stat_update(rtc, 0, MAXIM_DS3231_REG_STAT_OSF);
+		if (rc >= 0){
+			data->osf = false;
+		}
+	}
+
+	return (rc < 0) ? rc : 0;
 }
 
 /**
@@ -77,13 +97,22 @@ static int ds3231_calendar_settime(const struct device * dev, struct tm * tm) {
  * @param dev Pointer to the device structure for the driver instance.
  * @param tm Pointer to the time structure which will be populated with the
  * current calendar date
- * @retval 0
+ * @retval 0 on success
+ * @retval -ENODATA if the oscillator stopped and the time was not set since
+ * @retval -errno if the rtc could not be read
  */
-static int ds3231_calendar_gettime(const struct device * dev, struct tm * tm) {
+int ds3231_calendar_gettime(const struct device * dev, struct tm * tm) {
 	const struct ds3231_config * cfg = dev->config;
+	const struct ds3231_data * data = dev->data;
 	const struct device * rtc = cfg->rtc_dev;
 	uint32_t now = 0;
-	(void)counter_get_value(rtc, &now);
+	if (data->osf){
+		return -ENODATA;
+	}
+	int rc = counter_get_value(rtc, &now);
+	if (rc != 0){
+		return rc;
+	}
 	struct tm tv;
 	time_t tnow = now;
 	LOG_DBG("time now %u", now);
@@ -92,20 +121,27 @@ static int ds3231_calendar_gettime(const struct device * dev, struct tm * tm) {
 }
 
 /**
- * @brief Initialize calendar API. Gets the underlying rtc device
+ * @brief Initialize calendar API. Gets the underlying rtc device.
+ * 
+ * An oscillator fault does not fail init. Instead it is reported by
+ * `ds3231_calendar_gettime` until the time is set again, which also clears
+ * the fault, so that the time can be restored (e.g. by the redundant calendar).
  * 
  * @param dev Pointer to the device structure for the driver instance.
- * @retval 0
+ * @retval 0 on success
+ * @retval -errno if the rtc status could not be read
  */
 static int ds3231_rtc_initilize(const struct device *dev) {
 	const struct ds3231_config * cfg = dev->config;
+	struct ds3231_data * data = dev->data;
 	const struct device * rtc = cfg->rtc_dev;
-	int rc = maxim_ds3231_stat_update(rtc, 0, MAXIM_DS3231_REG_STAT_OSF);
+	int rc = maxim_ds3231_stat_update(rtc, 0, 0);
 	if (rc >= 0) {
+		data->osf = (rc & MAXIM_DS3231_REG_STAT_OSF) != 0;
 		LOG_DBG("DS3231 has%s experienced an oscillator fault",
-			(rc & MAXIM_DS3231_REG_STAT_OSF) ? "" : " not");
-		if (rc & MAXIM_DS3231_REG_STAT_OSF){
-			return rc;
+			data->osf ? "" : " not");
+		if (data->osf){
+			LOG_WRN("DS3231 oscillator fault, time must be set");
 		}
 		return 0;
 	} else {
@@ -123,8 +159,10 @@ struct ds3231_config ds3231_config = {
 	.rtc_dev = DEVICE_DT_GET(DT_INST_PHANDLE(0, rtc))
 };
 
+static struct ds3231_data ds3231_data;
+
 DEVICE_DT_INST_DEFINE(0, ds3231_rtc_initilize, NULL,
-	NULL, &ds3231_config,
+	&ds3231_data, &ds3231_config,
 	POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY,
 	&ds3231_calendar_api
 ); 
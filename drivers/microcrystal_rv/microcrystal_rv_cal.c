@@ -15,17 +15,26 @@
 #include <drivers/i2c.h>
 #include <zcal/calendar.h>
 #include <logging/log.h>
+#include <linker/section_tags.h>
 #include "microcrystal_registers.h"
 
 #define DT_DRV_COMPAT microcrystal_rv_calendar
 
-LOG_MODULE_REGISTER(calendar, CONFIG_CALENDAR_LOG_LEVEL);
+LOG_MODULE_REGISTER(calendar_rv, CONFIG_CALENDAR_LOG_LEVEL);
 
 #define member_size(type, member) sizeof(((type *)0)->member)
 
 #define RV_BIAS_YEAR 		2000
 #define TM_BIAS_YEAR		1900
 #define SRAM_MAGIC			(0xCA)
+#define WARM_BOOT_MAGIC		(0x52564341)
+
+/**
+ * Kept in ram which is not cleared on reset. If it holds `WARM_BOOT_MAGIC`,
+ * the mcu was reset without losing power, so the rtc sram was already
+ * validated and does not need to be read back over i2c.
+ */
+static uint32_t rv_warm_boot __noinit;
 
 struct rv_config{
 	const struct device * bus;
@@ -132,7 +141,7 @@ int rv_write(const struct device *dev, uint8_t reg, uint8_t *data, uint8_t len)
  * @retval 0 on success
  * @retval -errno on failure
  */
-static int rv_calendar_settime(const struct device * dev, struct tm * tm) {
+int rv_calendar_settime(const struct device * dev, struct tm * tm) {
 	rv_time_t time;
 	int rc = rv_convert_from_time(&time, tm);
 	if (rc == 0){
@@ -150,7 +159,7 @@ static int rv_calendar_settime(const struct device * dev, struct tm * tm) {
  * current calendar date
  * @retval 0
  */
-static int rv_calendar_gettime(const struct device * dev, struct tm * tm) {
+int rv_calendar_gettime(const struct device * dev, struct tm * tm) {
 	rv_time_t time = {0};
 	int rc = rv_read(dev, offsetof(rv_regmap_t, calendar), (uint8_t *)&time, sizeof(rv_time_t));
 	if (rc == 0){
@@ -197,6 +206,15 @@ static int rv_rtc_initilize(const struct device *dev) {
 			LOG_ERR("i2c bus for rv calendar is not ready");
 			return -EINVAL;
 		}
+		/* Warm boot: the mcu was reset without losing power, so the rtc
+		* did not either and its SRAM was already validated.
+		*/
+		if (IS_ENABLED(CONFIG_MICROCRYSTAL_RV_WARM_BOOT) &&
+			!IS_ENABLED(CONFIG_RESET_BACKUP_DOMAIN) && rv_warm_boot == WARM_BOOT_MAGIC)
+		{
+			LOG_DBG("Warm boot, skipping SRAM check");
+			return 0;
+		}
 		/* Only wipe the backup domain if:
 		*
 		* 1. It was requested or
@@ -207,6 +225,7 @@ static int rv_rtc_initilize(const struct device *dev) {
 		*/
 		uint8_t sram = 0;
 		int rc = get_sram_contents(dev, &sram);
+		bool sram_valid = (rc == 0);
 		if(IS_ENABLED(CONFIG_RESET_BACKUP_DOMAIN) ||  (rc == 0 && sram != SRAM_MAGIC))
 		{
 			LOG_DBG("Reseting backup domain. SRAM contents=0x%02x\n", sram);
@@ -215,8 +234,10 @@ static int rv_rtc_initilize(const struct device *dev) {
 			const time_t epoch = CONFIG_CALENDAR_INIT_TIME_UNIX_TIMESTAMP;
             t_init = gmtime_r(&epoch, &tv);
 			rc = rv_calendar_settime(dev, t_init);
-			set_sram_contents(dev, SRAM_MAGIC);
+			sram_valid = (rc == 0) && (set_sram_contents(dev, SRAM_MAGIC) == 0);
 		}
+		/* Only trust the next warm boot if the magic is known to be on the rtc */
+		rv_warm_boot = sram_valid ? WARM_BOOT_MAGIC : 0;
 	return rc;
 }
 
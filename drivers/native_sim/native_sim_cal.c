@@ -0,0 +1,181 @@
+/**
+ * @file native_sim_cal.c
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Implementation of calendar api for native_sim, driven by the host clock
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <spinlock.h>
+#include <sys/timeutil.h>
+#include <zcal/calendar.h>
+#include <zcal/native_sim_calendar.h>
+#include <logging/log.h>
+#include <native_rtc.h>
+
+#define DT_DRV_COMPAT zcal_native_sim_calendar
+
+LOG_MODULE_REGISTER(calendar_native_sim, CONFIG_CALENDAR_LOG_LEVEL);
+
+#define USEC_PER_SEC_64		((int64_t)USEC_PER_SEC)
+
+/**
+ * The calendar is modelled as an anchor point (a calendar time and the host
+ * time at which it was valid) which advances at `speedup` times the rate
+ * of the host clock. Setting the time or changing the speed just moves the
+ * anchor, so no state needs to be updated on the read path.
+ */
+struct native_sim_data{
+	struct k_spinlock lock;
+	int64_t anchor_host_us;
+	int64_t anchor_cal_us;
+	uint32_t speedup;
+	uint32_t latency_us;
+};
+
+/**
+ * @brief Read the host realtime clock
+ * 
+ * @retval host time in microseconds since epoch
+ */
+static inline int64_t native_sim_host_now_us(void){
+	return (int64_t)native_rtc_gettime_us(RTC_CLOCK_PSEUDOHOSTREALTIME);
+}
+
+/**
+ * @brief Compute the calendar time at a given host time.
+ * Must be called with the data lock held.
+ * 
+ * @param data : driver data
+ * @param host_us : host time in microseconds
+ * @retval calendar time in microseconds since epoch
+ */
+static inline int64_t native_sim_cal_us(const struct native_sim_data * data, int64_t host_us){
+	return data->anchor_cal_us + (host_us - data->anchor_host_us) * data->speedup;
+}
+
+/**
+ * @brief Emulate the access time of a real rtc, if configured
+ * 
+ * @param data : driver data
+ */
+static inline void native_sim_inject_latency(struct native_sim_data * data){
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	uint32_t latency_us = data->latency_us;
+	k_spin_unlock(&data->lock, key);
+	if (latency_us){
+		k_busy_wait(latency_us);
+	}
+}
+
+/**
+ * @brief Set the calendar time. The host clock is not modified, only
+ * the offset of the calendar relative to it.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param tm Pointer to the time structure describing the current calendar date
+ * @retval 0 on success
+ * @retval -EINVAL if tm is NULL
+ */
+int native_sim_calendar_settime(const struct device * dev, struct tm * tm) {
+	struct native_sim_data * data = dev->data;
+	if (tm == NULL){
+		return -EINVAL;
+	}
+	native_sim_inject_latency(data);
+	int64_t cal_us = (int64_t)timeutil_timegm(tm) * USEC_PER_SEC_64;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	data->anchor_host_us = native_sim_host_now_us();
+	data->anchor_cal_us = cal_us;
+	k_spin_unlock(&data->lock, key);
+	LOG_DBG("Calendar time set to %lld (unix timestamp)",
+		(long long)(cal_us / USEC_PER_SEC_64));
+	return 0;
+}
+
+/**
+ * @brief Function for getting the current calendar time as derived from
+ * the host clock
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param tm Pointer to the time structure which will be populated with the
+ * current calendar date
+ * @retval 0
+ */
+int native_sim_calendar_gettime(const struct device * dev, struct tm * tm) {
+	struct native_sim_data * data = dev->data;
+	native_sim_inject_latency(data);
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	int64_t cal_us = native_sim_cal_us(data, native_sim_host_now_us());
+	k_spin_unlock(&data->lock, key);
+	time_t now = (time_t)(cal_us / USEC_PER_SEC_64);
+	gmtime_r(&now, tm);
+	return 0;
+}
+
+int native_sim_calendar_offset(const struct device *dev, int64_t offset_sec){
+	struct native_sim_data * data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	data->anchor_cal_us += offset_sec * USEC_PER_SEC_64;
+	k_spin_unlock(&data->lock, key);
+	return 0;
+}
+
+int native_sim_calendar_set_speedup(const struct device *dev, uint32_t speedup){
+	struct native_sim_data * data = dev->data;
+	if (speedup == 0){
+		return -EINVAL;
+	}
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	/* Re-anchor at the current time so that the calendar does not jump */
+	int64_t host_us = native_sim_host_now_us();
+	data->anchor_cal_us = native_sim_cal_us(data, host_us);
+	data->anchor_host_us = host_us;
+	data->speedup = speedup;
+	k_spin_unlock(&data->lock, key);
+	return 0;
+}
+
+int native_sim_calendar_set_latency(const struct device *dev, uint32_t latency_us){
+	struct native_sim_data * data = dev->data;
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+	data->latency_us = latency_us;
+	k_spin_unlock(&data->lock, key);
+	return 0;
+}
+
+/**
+ * @brief Initialize calendar API. Anchors the calendar to the host clock,
+ * shifted by the configured offset.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @retval 0
+ */
+static int native_sim_rtc_initilize(const struct device *dev) {
+	struct native_sim_data * data = dev->data;
+	data->anchor_host_us = native_sim_host_now_us();
+	data->anchor_cal_us = data->anchor_host_us +
+		(int64_t)CONFIG_NATIVE_SIM_CALENDAR_OFFSET * USEC_PER_SEC_64;
+	data->speedup = CONFIG_NATIVE_SIM_CALENDAR_SPEEDUP;
+	data->latency_us = CONFIG_NATIVE_SIM_CALENDAR_LATENCY_US;
+	return 0;
+}
+
+static const struct calendar_driver_api native_sim_calendar_api = {
+	.settime = native_sim_calendar_settime,
+	.gettime = native_sim_calendar_gettime,
+};
+
+static struct native_sim_data native_sim_data;
+
+DEVICE_DT_INST_DEFINE(0, native_sim_rtc_initilize, NULL,
+	&native_sim_data, NULL,
+	POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+	&native_sim_calendar_api
+);
@@ -0,0 +1,473 @@
+/**
+ * @file redundant_cal.c
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Virtual calendar which aggregates several calendar backends
+ * and fails over between them
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ * 
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <stdlib.h>
+#include <sys/atomic.h>
+#include <sys/timeutil.h>
+#include <zcal/calendar.h>
+#include <logging/log.h>
+
+#define DT_DRV_COMPAT zcal_redundant_calendar
+
+LOG_MODULE_REGISTER(calendar_redundant, CONFIG_CALENDAR_LOG_LEVEL);
+
+#define REDUNDANT_NUM_SOURCES DT_INST_PROP_LEN(0, backends)
+
+/**
+ * The cross-check runs on its own work queue, since repairing a backend may
+ * block until work on the system work queue completes (e.g. the DS3231 driver).
+ */
+K_KERNEL_STACK_DEFINE(redundant_workq_stack, CONFIG_REDUNDANT_CALENDAR_WORKQ_STACK_SIZE);
+static struct k_work_q redundant_workq;
+
+/**
+ * History of a source as of the last cross-check. Used to detect a source
+ * which jumped (e.g. it lost power and restarted from the init time) by
+ * comparing it against the kernel uptime, which serves as a referee when
+ * there are only two sources to compare.
+ */
+struct redundant_history{
+	int64_t sec;
+	int64_t uptime_ms;
+	bool valid;
+};
+
+/* Outcome of reading a source during a cross-check */
+enum redundant_reading{
+	/* Not ready, or the read failed. Retried on the next check */
+	REDUNDANT_UNREADABLE,
+	/* The source reported that its time is invalid (-ENODATA) */
+	REDUNDANT_INVALID,
+	/* Read, but disagrees with its own history */
+	REDUNDANT_INCONSISTENT,
+	/* Read, and consistent with its history (or has none) */
+	REDUNDANT_CONSISTENT,
+};
+
+struct redundant_config{
+	const struct device * const * sources;
+	uint8_t num_sources;
+	uint32_t check_interval_ms;
+	uint32_t retry_interval_ms;
+	uint32_t tolerance_sec;
+	uint32_t uptime_drift_ppm;
+};
+
+struct redundant_data{
+	const struct device * dev;
+	/* Index of the source used on the read path */
+	atomic_t active;
+	/* Uptime (ms) at which a failed read last triggered a cross-check */
+	atomic_t last_trigger_ms;
+	/* Bitmask of sources which are known to be faulty */
+	ATOMIC_DEFINE(faults, REDUNDANT_NUM_SOURCES);
+	/* Serializes cross-checks and writes */
+	struct k_mutex lock;
+	struct k_work_delayable check_work;
+	struct redundant_history history[REDUNDANT_NUM_SOURCES];
+};
+
+static inline int redundant_source_gettime(const struct device * src, struct tm * tm){
+	const struct calendar_driver_api *api = src->api;
+	return api->gettime(src, tm);
+}
+
+static inline int redundant_source_settime(const struct device * src, struct tm * tm){
+	const struct calendar_driver_api *api = src->api;
+	return api->settime(src, tm);
+}
+
+/**
+ * @brief Check if a source may be used. Backends which failed their own
+ * init are never read or written, since their api may depend on state
+ * which was never set up.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param idx Index of the source
+ * @retval true if the source is ready and not known to be faulty
+ */
+static inline bool redundant_source_usable(const struct device * dev, int idx){
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	return !atomic_test_bit(data->faults, idx) && device_is_ready(cfg->sources[idx]);
+}
+
+/**
+ * @brief Select the highest priority source which is usable
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @retval index of the source, or -ENODEV if no source is usable
+ */
+static int redundant_select_active(const struct device * dev){
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	for (int i = 0; i < cfg->num_sources; i++){
+		if (redundant_source_usable(dev, i)){
+			atomic_set(&data->active, i);
+			return i;
+		}
+	}
+	return -ENODEV;
+}
+
+/**
+ * @brief Read a source and classify the reading against its history
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param idx Index of the source
+ * @param now_ms Uptime at the start of the check
+ * @param reading Populated with the time read, if any
+ * @retval classification of the reading
+ */
+static enum redundant_reading redundant_read_source(const struct device * dev, int idx,
+	int64_t now_ms, int64_t * reading){
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	const struct device * src = cfg->sources[idx];
+	struct redundant_history * hist = &data->history[idx];
+	struct tm tm;
+
+	if (!device_is_ready(src)){
+		return REDUNDANT_UNREADABLE;
+	}
+	int rc = redundant_source_gettime(src, &tm);
+	if (rc == -ENODATA){
+		LOG_WRN("source %s lost its time", src->name);
+		return REDUNDANT_INVALID;
+	} else if (rc != 0){
+		LOG_WRN("source %s failed to read: %d", src->name, rc);
+		return REDUNDANT_UNREADABLE;
+	}
+	*reading = timeutil_timegm64(&tm);
+
+	if (hist->valid){
+		/* Allow for drift of the uptime over the elapsed interval */
+		int64_t elapsed_ms = now_ms - hist->uptime_ms;
+		int64_t expected = hist->sec + elapsed_ms / MSEC_PER_SEC;
+		int64_t tolerance = cfg->tolerance_sec +
+			(elapsed_ms * cfg->uptime_drift_ppm) / (MSEC_PER_SEC * 1000000LL);
+		if (llabs(*reading - expected) > tolerance){
+			LOG_WRN("source %s jumped by %lld s", src->name,
+				(long long)(*reading - expected));
+			return REDUNDANT_INCONSISTENT;
+		}
+	}
+	return REDUNDANT_CONSISTENT;
+}
+
+/**
+ * @brief Cross-check every source against the others and repair the ones
+ * that lost their time or drifted from the reference.
+ * 
+ * The reference is the highest priority source whose reading is
+ * consistent with its own history. When there is no such source (i.e. at
+ * boot, or if the uptime itself stopped or drifted) the history is dropped
+ * and the latest reading is trusted instead, since an rtc which lost power
+ * restarts from a time in the past. That is only done when at least two
+ * sources answered, since a lone reading can't be told apart from a bad one.
+ * 
+ * Sources which could not be read are marked faulty and retried on the
+ * next check, but are never written.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @retval 0 if no source needs to be retried
+ * @retval -EAGAIN if a ready source failed and the check should be retried
+ * @retval -ENODEV if no source is healthy
+ */
+static int redundant_check(const struct device * dev){
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	enum redundant_reading status[REDUNDANT_NUM_SOURCES];
+	int64_t readings[REDUNDANT_NUM_SOURCES];
+	int answered = 0;
+	int ref = -1;
+	int rc = 0;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	int64_t now_ms = k_uptime_get();
+
+	for (int i = 0; i < cfg->num_sources; i++){
+		status[i] = redundant_read_source(dev, i, now_ms, &readings[i]);
+		if (status[i] == REDUNDANT_UNREADABLE){
+			atomic_set_bit(data->faults, i);
+			/* A backend which failed its own init will not recover by retrying */
+			if (device_is_ready(cfg->sources[i])){
+				rc = -EAGAIN;
+			}
+			continue;
+		}
+		answered++;
+		if (status[i] == REDUNDANT_CONSISTENT && data->history[i].valid && ref < 0){
+			ref = i;
+		}
+	}
+
+	if (ref < 0 && answered >= 2){
+		/* No source is backed by its history, so any history is what is
+		* wrong. Drop it and fall back to trusting the latest reading.
+		*/
+		for (int i = 0; i < cfg->num_sources; i++){
+			if (status[i] == REDUNDANT_INCONSISTENT){
+				status[i] = REDUNDANT_CONSISTENT;
+			}
+			if (status[i] != REDUNDANT_CONSISTENT){
+				continue;
+			}
+			data->history[i].valid = false;
+			if (ref < 0 || readings[i] > readings[ref]){
+				ref = i;
+			}
+		}
+	}
+
+	if (ref < 0){
+		/* Nothing to compare against. Keep serving reads from a source which
+		* answered, but don't write anything until the check is retried.
+		*/
+		for (int i = 0; i < cfg->num_sources; i++){
+			if (status[i] == REDUNDANT_INCONSISTENT){
+				data->history[i].valid = false;
+				status[i] = REDUNDANT_CONSISTENT;
+			}
+			if (status[i] == REDUNDANT_CONSISTENT){
+				atomic_clear_bit(data->faults, i);
+			} else {
+				atomic_set_bit(data->faults, i);
+			}
+		}
+		LOG_WRN("no reference calendar source");
+		if (redundant_select_active(dev) < 0){
+			rc = -ENODEV;
+		}
+		k_mutex_unlock(&data->lock);
+		return rc;
+	}
+
+	for (int i = 0; i < cfg->num_sources; i++){
+		const struct device * src = cfg->sources[i];
+		struct redundant_history * hist = &data->history[i];
+
+		if (status[i] == REDUNDANT_UNREADABLE){
+			continue;
+		}
+
+		if (status[i] == REDUNDANT_CONSISTENT &&
+			llabs(readings[i] - readings[ref]) <= cfg->tolerance_sec){
+			atomic_clear_bit(data->faults, i);
+			hist->sec = readings[i];
+			hist->uptime_ms = now_ms;
+			hist->valid = true;
+			continue;
+		}
+
+		/* Repair from the reference, accounting for the time spent so far */
+		int64_t elapsed_ms = k_uptime_get() - now_ms;
+		time_t repair = (time_t)(readings[ref] + elapsed_ms / MSEC_PER_SEC);
+		struct tm tm;
+		gmtime_r(&repair, &tm);
+		atomic_set_bit(data->faults, i);
+		hist->valid = false;
+		if (redundant_source_settime(src, &tm) == 0){
+			LOG_INF("repaired source %s from %s", src->name, cfg->sources[ref]->name);
+			atomic_clear_bit(data->faults, i);
+			hist->sec = repair;
+			hist->uptime_ms = now_ms + elapsed_ms;
+			hist->valid = true;
+		} else {
+			LOG_ERR("failed to repair source %s", src->name);
+			rc = -EAGAIN;
+		}
+	}
+
+	int active = redundant_select_active(dev);
+	if (active >= 0){
+		LOG_DBG("active source %s", cfg->sources[active]->name);
+	}
+	k_mutex_unlock(&data->lock);
+	return rc;
+}
+
+static void redundant_check_work(struct k_work * work){
+	struct k_work_delayable * dwork = k_work_delayable_from_work(work);
+	struct redundant_data * data = CONTAINER_OF(dwork, struct redundant_data, check_work);
+	const struct redundant_config * cfg = data->dev->config;
+
+	uint32_t delay_ms = (redundant_check(data->dev) == 0) ?
+		cfg->check_interval_ms : cfg->retry_interval_ms;
+	k_work_schedule_for_queue(&redundant_workq, &data->check_work, K_MSEC(delay_ms));
+}
+
+/**
+ * @brief Set the calendar time on every ready source
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param tm Pointer to the time structure describing the current calendar date
+ * @retval 0 if at least one source was updated
+ * @retval -errno if every source failed
+ */
+static int redundant_calendar_settime(const struct device * dev, struct tm * tm) {
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	int64_t sec = timeutil_timegm64(tm);
+	int rc = -ENODEV;
+	bool updated = false;
+
+	k_mutex_lock(&data->lock, K_FOREVER);
+	for (int i = 0; i < cfg->num_sources; i++){
+		struct redundant_history * hist = &data->history[i];
+		if (!device_is_ready(cfg->sources[i])){
+			continue;
+		}
+		rc = redundant_source_settime(cfg->sources[i], tm);
+		if (rc == 0){
+			atomic_clear_bit(data->faults, i);
+			hist->sec = sec;
+			hist->uptime_ms = k_uptime_get();
+			hist->valid = true;
+			updated = true;
+		} else {
+			LOG_WRN("failed to set source %s: %d", cfg->sources[i]->name, rc);
+			atomic_set_bit(data->faults, i);
+			hist->valid = false;
+		}
+	}
+	(void)redundant_select_active(dev);
+	k_mutex_unlock(&data->lock);
+
+	if (!updated){
+		return rc;
+	}
+	return 0;
+}
+
+/**
+ * @brief Schedule a cross-check after a failed read, at most once per
+ * retry interval so that a dead bus does not keep the work queue busy.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ */
+static void redundant_trigger_check(const struct device * dev){
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	uint32_t now_ms = k_uptime_get_32();
+	atomic_val_t last_ms = atomic_get(&data->last_trigger_ms);
+
+	if ((now_ms - (uint32_t)last_ms) >= cfg->retry_interval_ms &&
+		atomic_cas(&data->last_trigger_ms, last_ms, (atomic_val_t)now_ms)){
+		k_work_reschedule_for_queue(&redundant_workq, &data->check_work, K_NO_WAIT);
+	}
+}
+
+/**
+ * @brief Get the calendar time from the active source. If it fails,
+ * fail over to the next source and schedule a cross-check so that the
+ * faulty source is repaired in the background.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param tm Pointer to the time structure which will be populated with the
+ * current calendar date
+ * @retval 0 on success
+ * @retval -errno if every source failed
+ */
+static int redundant_calendar_gettime(const struct device * dev, struct tm * tm) {
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	int active = (int)atomic_get(&data->active);
+	int rc = -ENODEV;
+
+	if (redundant_source_usable(dev, active)){
+		rc = redundant_source_gettime(cfg->sources[active], tm);
+		if (rc == 0){
+			return 0;
+		}
+		atomic_set_bit(data->faults, active);
+	}
+	redundant_trigger_check(dev);
+
+	for (int i = 0; i < cfg->num_sources; i++){
+		if (i == active || !redundant_source_usable(dev, i)){
+			continue;
+		}
+		rc = redundant_source_gettime(cfg->sources[i], tm);
+		if (rc == 0){
+			atomic_cas(&data->active, active, i);
+			return 0;
+		}
+		atomic_set_bit(data->faults, i);
+	}
+	return rc;
+}
+
+/**
+ * @brief Initialize the redundant calendar. Cross-checks the sources once
+ * synchronously so the first read already comes from a healthy source.
+ * If no source is healthy yet, reads fail until the periodic check
+ * recovers one, rather than leaving the device not ready for good.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @retval 0
+ */
+static int redundant_rtc_initilize(const struct device *dev) {
+	const struct redundant_config * cfg = dev->config;
+	struct redundant_data * data = dev->data;
+	const struct k_work_queue_config workq_cfg = {
+		.name = "zcal_redundant",
+	};
+
+	data->dev = dev;
+	atomic_set(&data->last_trigger_ms, (atomic_val_t)(k_uptime_get_32() - cfg->retry_interval_ms));
+	k_mutex_init(&data->lock);
+	k_work_init_delayable(&data->check_work, redundant_check_work);
+	k_work_queue_start(&redundant_workq, redundant_workq_stack,
+		K_KERNEL_STACK_SIZEOF(redundant_workq_stack),
+		CONFIG_REDUNDANT_CALENDAR_WORKQ_PRIORITY, &workq_cfg);
+
+	int rc = redundant_check(dev);
+	if (rc == -ENODEV){
+		LOG_WRN("no healthy source at init, retrying in the background");
+	}
+	k_work_schedule_for_queue(&redundant_workq, &data->check_work,
+		K_MSEC(rc == 0 ? cfg->check_interval_ms : cfg->retry_interval_ms));
+	return 0;
+}
+
+static const struct calendar_driver_api redundant_calendar_api = {
+	.settime = redundant_calendar_settime,
+	.gettime = redundant_calendar_gettime,
+};
+
+#define REDUNDANT_SOURCE_GET(node_id, prop, idx) \
+	DEVICE_DT_GET(DT_PHANDLE_BY_IDX(node_id, prop, idx)),
+
+static const struct device * const redundant_sources[] = {
+	DT_INST_FOREACH_PROP_ELEM(0, backends, REDUNDANT_SOURCE_GET)
+};
+
+static const struct redundant_config redundant_config = {
+	.sources = redundant_sources,
+	.num_sources = REDUNDANT_NUM_SOURCES,
+	.check_interval_ms = DT_INST_PROP(0, check_interval_ms),
+	.retry_interval_ms = DT_INST_PROP(0, retry_interval_ms),
+	.tolerance_sec = DT_INST_PROP(0, tolerance_sec),
+	.uptime_drift_ppm = DT_INST_PROP(0, uptime_drift_ppm),
+};
+
+static struct redundant_data redundant_data;
+
+DEVICE_DT_INST_DEFINE(0, redundant_rtc_initilize, NULL,
+	&redundant_data, &redundant_config,
+	POST_KERNEL, CONFIG_REDUNDANT_CALENDAR_INIT_PRIORITY,
+	&redundant_calendar_api
+);
@@ -17,9 +17,10 @@
 #include <stm32f4xx_ll_pwr.h>
 #include <stm32f4xx_ll_rcc.h>
 #include <zcal/calendar.h>
+#include <zcal/stm32_rtc_cal.h>
 
 #include <logging/log.h>
-LOG_MODULE_REGISTER(calendar, CONFIG_CALENDAR_LOG_LEVEL);
+LOG_MODULE_REGISTER(calendar_stm32, CONFIG_CALENDAR_LOG_LEVEL);
 
 // prescaler values for LSE @ 32768 Hz
 #define RTC_PREDIV_ASYNC 0x7F
@@ -39,7 +40,7 @@ LOG_MODULE_REGISTER(calendar, CONFIG_CALENDAR_LOG_LEVEL);
  * @retval 0 on success
  * @retval -ECANCELLED on failure
  */
-static int stm32_calendar_settime(const struct device * dev, struct tm * tm) {
+int stm32_calendar_settime(const struct device * dev, struct tm * tm) {
 	(void) dev;
 
   /**
@@ -78,31 +79,21 @@ static int stm32_calendar_settime(const struct device * dev, struct tm * tm) {
 }
 
 /**
- * @brief Function for getting the current calendar time as recorded by the
- * battery backed rtc domain
+ * @brief Check if the backup domain retained a fully configured rtc,
+ * i.e. the magic word is present and the clock source and prescalers
+ * match what this driver would configure.
  * 
- * @param dev Pointer to the device structure for the driver instance.
- * @param tm Pointer to the time structure which will be populated with the
- * current calendar date
- * @retval 0
+ * @retval true if the rtc can be used without any reconfiguration
  */
-static int stm32_calendar_gettime(const struct device * dev, struct tm * tm) {
-
-	// 0x00HHMMSS in bcd format
-	uint32_t time = LL_RTC_TIME_Get(RTC);
-	// 0xWWDDMMYY in bcd format
-	uint32_t date = LL_RTC_DATE_Get(RTC);
-
-	tm->tm_sec = __LL_RTC_CONVERT_BCD2BIN(time & 0xFF);
-	tm->tm_min = __LL_RTC_CONVERT_BCD2BIN((time >> 8) & 0xFF);
-	tm->tm_hour = __LL_RTC_CONVERT_BCD2BIN((time >> 16) & 0xFF);
-
-	tm->tm_year = 100 + __LL_RTC_CONVERT_BCD2BIN(date & 0xFF);
-	tm->tm_mon = __LL_RTC_CONVERT_BCD2BIN((date >> 8) & 0xFF) - 1;
-	tm->tm_mday = __LL_RTC_CONVERT_BCD2BIN((date >> 16) & 0xFF);
-	tm->tm_wday = __LL_RTC_CONVERT_BCD2BIN((date >> 24) & 0xFF) - 1;
-
-	return 0;
+static bool stm32_rtc_is_configured(void) {
+  return !IS_ENABLED(CONFIG_RESET_BACKUP_DOMAIN) &&
+    LL_RTC_BAK_GetRegister(RTC, LL_RTC_BKP_DR0) == BAK_SRAM_MAGIC &&
+    LL_RCC_LSE_IsReady() &&
+    LL_RCC_IsEnabledRTC() &&
+    LL_RCC_GetRTCClockSource() == LL_RCC_RTC_CLKSOURCE_LSE &&
+    LL_RTC_GetHourFormat(RTC) == LL_RTC_HOURFORMAT_24HOUR &&
+    LL_RTC_GetAsynchPrescaler(RTC) == RTC_PREDIV_ASYNC &&
+    LL_RTC_GetSynchPrescaler(RTC) == RTC_PREDIV_SYNC;
 }
 
 /**
@@ -116,6 +107,27 @@ static int stm32_rtc_initilize(const struct device *dev) {
 
 	/* Clock Config */
   LL_PWR_EnableBkUpAccess();
+
+	/* GPIO Ports Clock Enable */
+  __HAL_RCC_GPIOC_CLK_ENABLE();
+
+  /* Warm boot: the rtc kept running through the reset, so skip the LSE
+  * startup and LL_RTC_Init, which would enter init mode and halt the
+  * calendar. Only wait for the shadow registers to resync so the first
+  * read is valid. If that times out, fall through to the full init.
+  */
+  if (stm32_rtc_is_configured())
+  {
+    LL_RTC_DisableWriteProtection(RTC);
+    ErrorStatus status = LL_RTC_WaitForSynchro(RTC);
+    LL_RTC_EnableWriteProtection(RTC);
+    if (status == SUCCESS)
+    {
+      LOG_DBG("rtc already configured, skipping init");
+      return 0;
+    }
+    LOG_WRN("rtc resync failed, reinitializing");
+  }
   
   /* Only wipe the backup domain if:
   *
@@ -143,9 +155,6 @@ static int stm32_rtc_initilize(const struct device *dev) {
   LL_RCC_SetRTCClockSource(LL_RCC_RTC_CLKSOURCE_LSE);
   LL_RCC_EnableRTC();
 
-	/* GPIO Ports Clock Enable */
-  __HAL_RCC_GPIOC_CLK_ENABLE();
-	
   /* Initialize RTC */
   LL_RTC_InitTypeDef RTC_InitStruct = {0};
 
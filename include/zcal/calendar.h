@@ -30,6 +30,36 @@ __subsystem struct calendar_driver_api {
     calendar_api_gettime gettime;
 };
 
+#ifdef CONFIG_CALENDAR_DIRECT_DISPATCH
+/*
+ * Exactly one backend is enabled, so bind the api directly to it rather than
+ * going through dev->api. The device handle is still passed along for
+ * backends which need their config, but it must be that backend's device.
+ * User threads still go through the syscall, since the backends access
+ * privileged peripherals.
+ */
+#if defined(CONFIG_STM32_RTC_CALENDAR)
+#include <zcal/stm32_rtc_cal.h>
+#define Z_CALENDAR_DIRECT_SETTIME stm32_calendar_settime
+#define Z_CALENDAR_DIRECT_GETTIME stm32_calendar_gettime
+#elif defined(CONFIG_DS3231_RTC_CALENDAR)
+int ds3231_calendar_settime(const struct device * dev, struct tm * tm);
+int ds3231_calendar_gettime(const struct device * dev, struct tm * tm);
+#define Z_CALENDAR_DIRECT_SETTIME ds3231_calendar_settime
+#define Z_CALENDAR_DIRECT_GETTIME ds3231_calendar_gettime
+#elif defined(CONFIG_MICROCRYSTAL_RV_RTC_CALENDAR)
+int rv_calendar_settime(const struct device * dev, struct tm * tm);
+int rv_calendar_gettime(const struct device * dev, struct tm * tm);
+#define Z_CALENDAR_DIRECT_SETTIME rv_calendar_settime
+#define Z_CALENDAR_DIRECT_GETTIME rv_calendar_gettime
+#elif defined(CONFIG_NATIVE_SIM_RTC_CALENDAR)
+int native_sim_calendar_settime(const struct device * dev, struct tm * tm);
+int native_sim_calendar_gettime(const struct device * dev, struct tm * tm);
+#define Z_CALENDAR_DIRECT_SETTIME native_sim_calendar_settime
+#define Z_CALENDAR_DIRECT_GETTIME native_sim_calendar_gettime
+#endif
+#endif
+
 /**
  * @brief Function for getting the current calendar time as recorded by the
  * calendar driver
@@ -38,16 +68,22 @@ __subsystem struct calendar_driver_api {
  * @param tm Pointer to the time structure which will be populated with the
  * current calendar date
  * @retval 0 if success
+ * @retval -ENODATA if the backend lost its time (e.g. an oscillator fault)
+ * and it has not been set since
  * @retval -errno otherwise
  */
 __syscall int calendar_gettime(const struct device *dev, struct tm *tm);
 
 static inline int z_impl_calendar_gettime(const struct device *dev, struct tm *tm)
 {
+#ifdef Z_CALENDAR_DIRECT_GETTIME
+	return Z_CALENDAR_DIRECT_GETTIME(dev, tm);
+#else
 	const struct calendar_driver_api *api =
 				(struct calendar_driver_api *)dev->api;
 
 	return api->gettime(dev, tm);
+#endif
 }
 
 /**
@@ -63,10 +99,14 @@ __syscall int calendar_settime(const struct device *dev, struct tm *tm);
 
 static inline int z_impl_calendar_settime(const struct device *dev, struct tm *tm)
 {
+#ifdef Z_CALENDAR_DIRECT_SETTIME
+	return Z_CALENDAR_DIRECT_SETTIME(dev, tm);
+#else
 	const struct calendar_driver_api *api =
 				(struct calendar_driver_api *)dev->api;
 
 	return api->settime(dev, tm);
+#endif
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,83 @@
+/**
+ * @file format.h
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Allocation free ISO-8601 / RFC 3339 formatting and parsing
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_EXTRAS_INCLUDE_DRIVERS_CALENDAR_FORMAT_H_
+#define ZEPHYR_EXTRAS_INCLUDE_DRIVERS_CALENDAR_FORMAT_H_
+
+#include <time.h>
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Append milliseconds, e.g. `2022-11-30T21:25:27.123Z` */
+#define ZCAL_FORMAT_MSEC	(1U << 0)
+/** Append the utc offset as `+hh:mm` rather than `Z`, including `+00:00` for utc */
+#define ZCAL_FORMAT_OFFSET	(1U << 1)
+
+/** Buffer size which fits the longest formatted string, including the terminator */
+#define ZCAL_FORMAT_MAX_LEN	sizeof("YYYY-MM-DDTHH:MM:SS.sss+HH:MM")
+
+/**
+ * @brief Format a calendar date as an RFC 3339 string
+ * (`YYYY-MM-DDTHH:MM:SS[.sss](Z|+hh:mm)`)
+ * 
+ * @param buf Buffer which will hold the null terminated string
+ * @param size Size of `buf`. `ZCAL_FORMAT_MAX_LEN` is always sufficient
+ * @param tm Calendar date, already expressed in the local time of `utc_offset_min`
+ * @param msec Milliseconds (0-999), only used with `ZCAL_FORMAT_MSEC`
+ * @param utc_offset_min Offset from utc in minutes, only used with `ZCAL_FORMAT_OFFSET`
+ * @param flags Combination of `ZCAL_FORMAT_*` flags
+ * @retval length of the string (excluding the terminator) on success
+ * @retval -EINVAL if a field is out of range
+ * @retval -ENOMEM if `buf` is too small
+ */
+int zcal_format_tm(char *buf, size_t size, const struct tm *tm,
+		   uint16_t msec, int16_t utc_offset_min, uint32_t flags);
+
+/**
+ * @brief Format a unix timestamp as an RFC 3339 string
+ * 
+ * @param buf Buffer which will hold the null terminated string
+ * @param size Size of `buf`. `ZCAL_FORMAT_MAX_LEN` is always sufficient
+ * @param epoch_ms Milliseconds since January 1 1970 utc
+ * @param utc_offset_min Offset from utc in minutes, only used with `ZCAL_FORMAT_OFFSET`
+ * @param flags Combination of `ZCAL_FORMAT_*` flags
+ * @retval length of the string (excluding the terminator) on success
+ * @retval -EINVAL if the date is outside of years 0000-9999
+ * @retval -ENOMEM if `buf` is too small
+ */
+int zcal_format_epoch(char *buf, size_t size, int64_t epoch_ms,
+		      int16_t utc_offset_min, uint32_t flags);
+
+/**
+ * @brief Parse an RFC 3339 / ISO-8601 date time into a utc calendar date
+ * which can be passed directly to `calendar_settime`.
+ * 
+ * Accepts `YYYY-MM-DD(T|t| )HH:MM:SS[.f...][Z|z|+hh:mm|-hh:mm]`. Fractional
+ * seconds are truncated to milliseconds, and a missing offset is taken as utc.
+ * 
+ * @param str String to parse, it does not need to be null terminated
+ * @param len Maximum number of characters to read from `str`
+ * @param tm Populated with the utc calendar date
+ * @param msec If not NULL, populated with the milliseconds
+ * @retval number of characters consumed on success
+ * @retval -EINVAL if the string is malformed or a field is out of range
+ */
+int zcal_parse_rfc3339(const char *str, size_t len, struct tm *tm, uint16_t *msec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
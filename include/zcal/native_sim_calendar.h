@@ -0,0 +1,55 @@
+/**
+ * @file native_sim_calendar.h
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Runtime controls for the native_sim calendar backend
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_EXTRAS_INCLUDE_DRIVERS_NATIVE_SIM_CALENDAR_H_
+#define ZEPHYR_EXTRAS_INCLUDE_DRIVERS_NATIVE_SIM_CALENDAR_H_
+
+#include <zephyr/types.h>
+#include <device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Shift the calendar time relative to its current value
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param offset_sec Signed number of seconds to add to the calendar time
+ * @retval 0
+ */
+int native_sim_calendar_offset(const struct device *dev, int64_t offset_sec);
+
+/**
+ * @brief Change how fast the calendar advances relative to the host clock.
+ * The current calendar time is preserved across the change.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param speedup Calendar seconds per host second
+ * @retval 0 on success
+ * @retval -EINVAL if speedup is 0
+ */
+int native_sim_calendar_set_speedup(const struct device *dev, uint32_t speedup);
+
+/**
+ * @brief Change the latency injected into every get and set
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param latency_us Busy wait duration in microseconds
+ * @retval 0
+ */
+int native_sim_calendar_set_latency(const struct device *dev, uint32_t latency_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
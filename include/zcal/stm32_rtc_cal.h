@@ -0,0 +1,67 @@
+/**
+ * @file stm32_rtc_cal.h
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Inline read path of the stm32 rtc calendar backend
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_EXTRAS_INCLUDE_DRIVERS_STM32_RTC_CAL_H_
+#define ZEPHYR_EXTRAS_INCLUDE_DRIVERS_STM32_RTC_CAL_H_
+
+#include <time.h>
+#include <device.h>
+#include <stm32f4xx_ll_rtc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set the calendar time to the battery backed rtc domain
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param tm Pointer to the time structure describing the current calendar date
+ * @retval 0 on success
+ * @retval -ECANCELLED on failure
+ */
+int stm32_calendar_settime(const struct device * dev, struct tm * tm);
+
+/**
+ * @brief Function for getting the current calendar time as recorded by the
+ * battery backed rtc domain. Defined inline so that it can be bound directly
+ * by `CONFIG_CALENDAR_DIRECT_DISPATCH`.
+ * 
+ * @param dev Pointer to the device structure for the driver instance.
+ * @param tm Pointer to the time structure which will be populated with the
+ * current calendar date
+ * @retval 0
+ */
+static inline int stm32_calendar_gettime(const struct device * dev, struct tm * tm) {
+	(void) dev;
+
+	// 0x00HHMMSS in bcd format
+	uint32_t time = LL_RTC_TIME_Get(RTC);
+	// 0xWWDDMMYY in bcd format
+	uint32_t date = LL_RTC_DATE_Get(RTC);
+
+	tm->tm_sec = __LL_RTC_CONVERT_BCD2BIN(time & 0xFF);
+	tm->tm_min = __LL_RTC_CONVERT_BCD2BIN((time >> 8) & 0xFF);
+	tm->tm_hour = __LL_RTC_CONVERT_BCD2BIN((time >> 16) & 0xFF);
+
+	tm->tm_year = 100 + __LL_RTC_CONVERT_BCD2BIN(date & 0xFF);
+	tm->tm_mon = __LL_RTC_CONVERT_BCD2BIN((date >> 8) & 0xFF) - 1;
+	tm->tm_mday = __LL_RTC_CONVERT_BCD2BIN((date >> 16) & 0xFF);
+	tm->tm_wday = __LL_RTC_CONVERT_BCD2BIN((date >> 24) & 0xFF) - 1;
+
+	return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @file main.c
+ * @author Brian Bradley (brian.bradley.p@gmail.com)
+ * @brief Tests for the ISO-8601 / RFC 3339 formatting and parsing routines
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (C) 2026 Brian Bradley
+ * 
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <time.h>
+#include <string.h>
+#include <stdio.h>
+#include <zcal/format.h>
+
+#define ROUND_TRIP_ITERATIONS	100000
+
+/* 0001-01-01T00:00:00Z and 9999-12-31T23:59:59Z */
+#define EPOCH_SEC_MIN		(-62135596800LL)
+#define EPOCH_SEC_MAX		(253402300799LL)
+
+static void test_format_epoch(void)
+{
+	char buf[ZCAL_FORMAT_MAX_LEN];
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 1669843527123LL, 0, 0), 20, NULL);
+	zassert_true(strcmp(buf, "2022-11-30T21:25:27Z") == 0, "%s", buf);
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 1669843527123LL, 0,
+		ZCAL_FORMAT_MSEC), 24, NULL);
+	zassert_true(strcmp(buf, "2022-11-30T21:25:27.123Z") == 0, "%s", buf);
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 1669843527123LL, -330,
+		ZCAL_FORMAT_MSEC | ZCAL_FORMAT_OFFSET), 29, NULL);
+	zassert_true(strcmp(buf, "2022-11-30T15:55:27.123-05:30") == 0, "%s", buf);
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 0, 0, ZCAL_FORMAT_OFFSET), 25, NULL);
+	zassert_true(strcmp(buf, "1970-01-01T00:00:00+00:00") == 0, "%s", buf);
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), -1, 0, ZCAL_FORMAT_MSEC), 24, NULL);
+	zassert_true(strcmp(buf, "1969-12-31T23:59:59.999Z") == 0, "%s", buf);
+
+	/* The offset is ignored without ZCAL_FORMAT_OFFSET */
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 0, 3000, 0), 20, NULL);
+	zassert_true(strcmp(buf, "1970-01-01T00:00:00Z") == 0, "%s", buf);
+}
+
+static void test_format_epoch_limits(void)
+{
+	char buf[ZCAL_FORMAT_MAX_LEN];
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), -62167219200000LL, 0, 0), 20, NULL);
+	zassert_true(strcmp(buf, "0000-01-01T00:00:00Z") == 0, "%s", buf);
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 253402300799999LL, 0, 0), 20, NULL);
+	zassert_true(strcmp(buf, "9999-12-31T23:59:59Z") == 0, "%s", buf);
+
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), -62167219200001LL, 0, 0), -EINVAL, NULL);
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 253402300800000LL, 0, 0), -EINVAL, NULL);
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), INT64_MIN, 0, 0), -EINVAL, NULL);
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), INT64_MAX, 0, 0), -EINVAL, NULL);
+	zassert_equal(zcal_format_epoch(buf, sizeof(buf), 0, 24 * 60, ZCAL_FORMAT_OFFSET),
+		-EINVAL, NULL);
+	zassert_equal(zcal_format_epoch(buf, sizeof("YYYY-MM-DDTHH:MM:SS"), 0, 0, 0),
+		-ENOMEM, NULL);
+}
+
+static void test_format_tm(void)
+{
+	char buf[ZCAL_FORMAT_MAX_LEN];
+	struct tm tm = {
+		.tm_year = 122, .tm_mon = 10, .tm_mday = 30,
+		.tm_hour = 1, .tm_min = 2, .tm_sec = 3,
+	};
+
+	zassert_equal(zcal_format_tm(buf, sizeof(buf), &tm, 45, 60,
+		ZCAL_FORMAT_MSEC | ZCAL_FORMAT_OFFSET), 29, NULL);
+	zassert_true(strcmp(buf, "2022-11-30T01:02:03.045+01:00") == 0, "%s", buf);
+
+	/* February 31st does not exist */
+	tm.tm_mon = 1;
+	tm.tm_mday = 31;
+	zassert_equal(zcal_format_tm(buf, sizeof(buf), &tm, 0, 0, 0), -EINVAL, NULL);
+
+	/* February 29th only exists in leap years */
+	tm.tm_mday = 29;
+	zassert_equal(zcal_format_tm(buf, sizeof(buf), &tm, 0, 0, 0), -EINVAL, NULL);
+	tm.tm_year = 100;
+	zassert_equal(zcal_format_tm(buf, sizeof(buf), &tm, 0, 0, 0), 20, NULL);
+	zassert_true(strcmp(buf, "2000-02-29T01:02:03Z") == 0, "%s", buf);
+}
+
+static void test_parse(void)
+{
+	struct tm tm;
+	uint16_t msec = 0;
+
+	zassert_equal(zcal_parse_rfc3339("2022-11-30t21:25:27.9z,rest", 100, &tm, &msec),
+		22, NULL);
+	zassert_equal(msec, 900, NULL);
+	zassert_equal(tm.tm_hour, 21, NULL);
+
+	/* Shifted to utc, rolling over into the next day */
+	zassert_equal(zcal_parse_rfc3339("2022-12-31T22:00:00-05:00", 100, &tm, NULL),
+		25, NULL);
+	zassert_equal(tm.tm_year, 123, NULL);
+	zassert_equal(tm.tm_mon, 0, NULL);
+	zassert_equal(tm.tm_mday, 1, NULL);
+	zassert_equal(tm.tm_hour, 3, NULL);
+	zassert_equal(tm.tm_wday, 0, NULL);
+	zassert_equal(tm.tm_yday, 0, NULL);
+
+	/* Leap seconds are clamped */
+	zassert_equal(zcal_parse_rfc3339("2022-11-30T21:25:60Z", 100, &tm, NULL), 20, NULL);
+	zassert_equal(tm.tm_sec, 59, NULL);
+
+	/* Missing offset is taken as utc */
+	zassert_equal(zcal_parse_rfc3339("2022-11-30 21:25:27", 100, &tm, NULL), 19, NULL);
+
+	zassert_equal(zcal_parse_rfc3339("2022-02-30T21:25:27Z", 100, &tm, NULL), -EINVAL, NULL);
+	zassert_equal(zcal_parse_rfc3339("2022-11-30T21:25", 100, &tm, NULL), -EINVAL, NULL);
+	zassert_equal(zcal_parse_rfc3339("2022-11-30T21:25:27.", 100, &tm, NULL), -EINVAL, NULL);
+	zassert_equal(zcal_parse_rfc3339("2022-11-30T21:25:27+05", 100, &tm, NULL), -EINVAL, NULL);
+	zassert_equal(zcal_parse_rfc3339("2022-11-30T21:25:27Z", 10, &tm, NULL), -EINVAL, NULL);
+}
+
+/**
+ * Format random timestamps with random offsets, compare against gmtime_r,
+ * and parse them back to the original utc time.
+ */
+static void test_round_trip(void)
+{
+	char buf[ZCAL_FORMAT_MAX_LEN];
+	char ref[ZCAL_FORMAT_MAX_LEN];
+	uint64_t seed = 0x2545F4914F6CDD1DULL;
+
+	for (int i = 0; i < ROUND_TRIP_ITERATIONS; i++){
+		/* xorshift64 */
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+
+		int64_t sec = EPOCH_SEC_MIN + (int64_t)(seed % (EPOCH_SEC_MAX - EPOCH_SEC_MIN));
+		int16_t offset = (int16_t)((int)((seed >> 40) % 2877) - 1438);
+		uint16_t msec = (uint16_t)((seed >> 20) % 1000);
+		time_t local = (time_t)(sec + offset * 60);
+		struct tm expected;
+		struct tm utc;
+		struct tm parsed;
+		uint16_t parsed_msec;
+
+		if (local < EPOCH_SEC_MIN || local > EPOCH_SEC_MAX){
+			continue;
+		}
+		gmtime_r(&local, &expected);
+		snprintf(ref, sizeof(ref), "%04d-%02d-%02dT%02d:%02d:%02d",
+			expected.tm_year + 1900, expected.tm_mon + 1, expected.tm_mday,
+			expected.tm_hour, expected.tm_min, expected.tm_sec);
+
+		int len = zcal_format_epoch(buf, sizeof(buf), sec * 1000 + msec, offset,
+			ZCAL_FORMAT_MSEC | ZCAL_FORMAT_OFFSET);
+		zassert_equal(len, 29, "%lld", (long long)sec);
+		zassert_true(strncmp(buf, ref, strlen(ref)) == 0, "%s != %s", buf, ref);
+
+		zassert_equal(zcal_parse_rfc3339(buf, sizeof(buf), &parsed, &parsed_msec),
+			len, "%s", buf);
+		time_t t = (time_t)sec;
+		gmtime_r(&t, &utc);
+		zassert_equal(parsed_msec, msec, "%s", buf);
+		zassert_equal(parsed.tm_year, utc.tm_year, "%s", buf);
+		zassert_equal(parsed.tm_mon, utc.tm_mon, "%s", buf);
+		zassert_equal(parsed.tm_mday, utc.tm_mday, "%s", buf);
+		zassert_equal(parsed.tm_hour, utc.tm_hour, "%s", buf);
+		zassert_equal(parsed.tm_min, utc.tm_min, "%s", buf);
+		zassert_equal(parsed.tm_sec, utc.tm_sec, "%s", buf);
+		zassert_equal(parsed.tm_wday, utc.tm_wday, "%s", buf);
+		zassert_equal(parsed.tm_yday, utc.tm_yday, "%s", buf);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(zcal_format,
+			 ztest_unit_test(test_format_epoch),
+			 ztest_unit_test(test_format_epoch_limits),
+			 ztest_unit_test(test_format_tm),
+			 ztest_unit_test(test_parse),
+			 ztest_unit_test(test_round_trip)
+	);
+	ztest_run_test_suite(zcal_format);
+}